@@ -0,0 +1,128 @@
+#ifndef ALUES_CORE_H
+#define ALUES_CORE_H
+
+// Plain C/C++ interface to the ALUES scoring engine. Nothing in here depends
+// on R or Rcpp: all inputs and outputs are raw buffers, so the engine can be
+// linked into any C or C++ program. The Rcpp exports in src/ are thin wrappers
+// around these functions.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Suitability classes, ordered from least to most suitable
+#define ALUES_NA  -1
+#define ALUES_N    0
+#define ALUES_S3   1
+#define ALUES_S2   2
+#define ALUES_S1   3
+
+// Membership functions
+#define ALUES_TRIANGULAR  1
+#define ALUES_TRAPEZOIDAL 2
+#define ALUES_GAUSSIAN    3
+
+// Shape of the crop requirement, i.e. which face of the MF is used
+#define ALUES_CASE_A 1 // right face, 3 limits in decreasing order
+#define ALUES_CASE_B 2 // left face, 3 limits in increasing order
+#define ALUES_CASE_C 3 // full face, 6 limits
+#define ALUES_CASE_D 4 // 5 limits, S3 above optimum missing
+#define ALUES_CASE_E 5 // 4 limits, S2 and S3 above optimum missing
+
+// Methods for the overall suitability
+#define ALUES_MINIMUM 1
+#define ALUES_MAXIMUM 2
+#define ALUES_AVERAGE 3
+
+// How the minimum and maximum of a factor are obtained
+#define ALUES_BOUND_FIXED   0
+#define ALUES_BOUND_AVERAGE 1
+
+// Measurement error models of a factor
+#define ALUES_ERROR_NONE     0
+#define ALUES_ERROR_GAUSSIAN 1 // p1 is the standard deviation
+#define ALUES_ERROR_UNIFORM  2 // p1 and p2 are the lower and upper offsets
+
+// Return codes, positive values are warnings and negative values are errors
+#define ALUES_OK              0
+#define ALUES_WARN_MIN_ZERO   1 // minimum set to zero, all class limits are equal
+#define ALUES_WARN_MAX_LIMIT  2 // maximum set to the last class limit
+#define ALUES_ERR_LIMITS     -1 // requirement limits cannot be evaluated
+#define ALUES_ERR_ARGS       -2 // unrecognized membership function or method
+
+typedef struct {
+  int mf;         // membership function
+  int bias;       // 1 if the class limits follow the shape of the MF ("unbias")
+  double l[5];    // class limits for N, S3, S2 and S1, used when bias is 0
+  double sigma;   // spread of the gaussian MF
+} alues_options;
+
+typedef struct {
+  int shape;                  // one of ALUES_CASE_*
+  double min, max, mid;       // domain of the MF
+  double a, b, c, d, e, f;    // class limits of the requirement
+} alues_factor;
+
+typedef struct {
+  int type;       // one of ALUES_ERROR_*
+  double p1, p2;  // parameters of the error model
+} alues_error;
+
+// Default options: triangular MF, fixed 0, .25, .5, .75, 1 limits, sigma 1
+void alues_options_init(alues_options *opt);
+
+// Prepares a factor from one row of a crop requirement table. req holds the
+// six limits s3_a, s2_a, s1_a, s1_b, s2_b, s3_b with NaN for missing entries.
+// The bounds are either fixed to the given value or derived from the average
+// spacing of the limits.
+int alues_factor_init(alues_factor *f, const double *req, int min_mode, double minimum,
+                      int max_mode, double maximum);
+
+// Scores n land units on a single factor. score and cls must hold n values.
+int alues_score(const alues_factor *f, const alues_options *opt, const double *x, int n,
+                double *score, int *cls);
+
+// Aggregates an nrow x ncol column-major matrix of scores into the overall
+// suitability. wts may be NULL or hold ncol weights with NaN for missing, and
+// interval may be NULL for the default class limits.
+int alues_overall(const double *score, int nrow, int ncol, const double *wts, int method,
+                  const double *interval, double *out_score, int *out_class);
+
+// As alues_overall, and also finds the factor limiting each land unit in the
+// same pass. first and second hold the column of the lowest and second lowest
+// scores, -1 when there is none, and margin the difference between the two.
+// second and margin may be NULL.
+int alues_overall_limiting(const double *score, int nrow, int ncol, const double *wts, int method,
+                           const double *interval, double *out_score, int *out_class,
+                           int *first, int *second, double *margin);
+
+// Propagates the measurement error of the factors to the overall suitability
+// by Monte Carlo. x is the n x m column-major matrix of land units, with f and
+// err holding the m factors and their error models; factors whose shape is 0
+// are not scored but still count in the weights. Each land unit draws its own
+// stream from seed, so the results do not depend on the number of threads.
+// freq is n x 4 and holds the fraction of samples in each class, indexed by
+// the ALUES_N .. ALUES_S1 codes; mean and var hold the overall score moments.
+int alues_uncertainty(const alues_factor *f, const alues_error *err, int m, const alues_options *opt,
+                      const double *x, int n, const double *wts, int method, const double *interval,
+                      int samples, uint64_t seed, int threads, double *freq, double *mean, double *var);
+
+// Scores a panel of monthly climate data, x is the n x years x 12 array of
+// land units, years and months in column-major order. For each of the m
+// factors, month gives the month it is read from (0 for January) and lag is 1
+// when it is read from the following year. score and cls are n x years, and
+// freq is n x 4 with the fraction of years in each class, as in alues_uncertainty.
+int alues_panel(const alues_factor *f, const int *month, const int *lag, int m, const alues_options *opt,
+                const double *x, int n, int years, const double *wts, int method, const double *interval,
+                double *score, int *cls, double *freq);
+
+// Class label, e.g. "S1", for one of the ALUES_* class codes
+const char *alues_class_name(int cls);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
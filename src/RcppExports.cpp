@@ -10,155 +10,108 @@ Rcpp::Rostream<true>&  Rcpp::Rcout = Rcpp::Rcpp_cout_get();
 Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
-// case_a
-List case_a(NumericMatrix df, NumericMatrix score, CharacterMatrix suiClass, double Min, double Max, double mfNum, double bias, int j, double a, double b, double c, double l1, double l2, double l3, double l4, double l5, double sigma);
-RcppExport SEXP _ALUES_case_a(SEXP dfSEXP, SEXP scoreSEXP, SEXP suiClassSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP jSEXP, SEXP aSEXP, SEXP bSEXP, SEXP cSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP) {
+// overall_score
+List overall_score(NumericMatrix x, NumericVector wts, int method, NumericVector interval);
+RcppExport SEXP _ALUES_overall_score(SEXP xSEXP, SEXP wtsSEXP, SEXP methodSEXP, SEXP intervalSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< NumericMatrix >::type df(dfSEXP);
-    Rcpp::traits::input_parameter< NumericMatrix >::type score(scoreSEXP);
-    Rcpp::traits::input_parameter< CharacterMatrix >::type suiClass(suiClassSEXP);
-    Rcpp::traits::input_parameter< double >::type Min(MinSEXP);
-    Rcpp::traits::input_parameter< double >::type Max(MaxSEXP);
-    Rcpp::traits::input_parameter< double >::type mfNum(mfNumSEXP);
-    Rcpp::traits::input_parameter< double >::type bias(biasSEXP);
-    Rcpp::traits::input_parameter< int >::type j(jSEXP);
-    Rcpp::traits::input_parameter< double >::type a(aSEXP);
-    Rcpp::traits::input_parameter< double >::type b(bSEXP);
-    Rcpp::traits::input_parameter< double >::type c(cSEXP);
-    Rcpp::traits::input_parameter< double >::type l1(l1SEXP);
-    Rcpp::traits::input_parameter< double >::type l2(l2SEXP);
-    Rcpp::traits::input_parameter< double >::type l3(l3SEXP);
-    Rcpp::traits::input_parameter< double >::type l4(l4SEXP);
-    Rcpp::traits::input_parameter< double >::type l5(l5SEXP);
-    Rcpp::traits::input_parameter< double >::type sigma(sigmaSEXP);
-    rcpp_result_gen = Rcpp::wrap(case_a(df, score, suiClass, Min, Max, mfNum, bias, j, a, b, c, l1, l2, l3, l4, l5, sigma));
-    return rcpp_result_gen;
-END_RCPP
-}
-// case_b
-List case_b(NumericMatrix df, NumericMatrix score, CharacterMatrix suiClass, double Min, double Max, double mfNum, double bias, int j, double a, double b, double c, double l1, double l2, double l3, double l4, double l5, double sigma);
-RcppExport SEXP _ALUES_case_b(SEXP dfSEXP, SEXP scoreSEXP, SEXP suiClassSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP jSEXP, SEXP aSEXP, SEXP bSEXP, SEXP cSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP) {
-BEGIN_RCPP
-    Rcpp::RObject rcpp_result_gen;
-    Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< NumericMatrix >::type df(dfSEXP);
-    Rcpp::traits::input_parameter< NumericMatrix >::type score(scoreSEXP);
-    Rcpp::traits::input_parameter< CharacterMatrix >::type suiClass(suiClassSEXP);
-    Rcpp::traits::input_parameter< double >::type Min(MinSEXP);
-    Rcpp::traits::input_parameter< double >::type Max(MaxSEXP);
-    Rcpp::traits::input_parameter< double >::type mfNum(mfNumSEXP);
-    Rcpp::traits::input_parameter< double >::type bias(biasSEXP);
-    Rcpp::traits::input_parameter< int >::type j(jSEXP);
-    Rcpp::traits::input_parameter< double >::type a(aSEXP);
-    Rcpp::traits::input_parameter< double >::type b(bSEXP);
-    Rcpp::traits::input_parameter< double >::type c(cSEXP);
-    Rcpp::traits::input_parameter< double >::type l1(l1SEXP);
-    Rcpp::traits::input_parameter< double >::type l2(l2SEXP);
-    Rcpp::traits::input_parameter< double >::type l3(l3SEXP);
-    Rcpp::traits::input_parameter< double >::type l4(l4SEXP);
-    Rcpp::traits::input_parameter< double >::type l5(l5SEXP);
-    Rcpp::traits::input_parameter< double >::type sigma(sigmaSEXP);
-    rcpp_result_gen = Rcpp::wrap(case_b(df, score, suiClass, Min, Max, mfNum, bias, j, a, b, c, l1, l2, l3, l4, l5, sigma));
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type wts(wtsSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type interval(intervalSEXP);
+    rcpp_result_gen = Rcpp::wrap(overall_score(x, wts, method, interval));
     return rcpp_result_gen;
 END_RCPP
 }
-// case_c
-List case_c(NumericMatrix df, NumericMatrix score, CharacterMatrix suiClass, double Min, double Max, double Mid, double mfNum, double bias, int j, double a, double b, double c, double d, double e, double f, double l1, double l2, double l3, double l4, double l5, double sigma);
-RcppExport SEXP _ALUES_case_c(SEXP dfSEXP, SEXP scoreSEXP, SEXP suiClassSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP MidSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP jSEXP, SEXP aSEXP, SEXP bSEXP, SEXP cSEXP, SEXP dSEXP, SEXP eSEXP, SEXP fSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP) {
+// panel_score
+List panel_score(NumericVector x, IntegerVector month, IntegerVector lag, NumericMatrix limits, NumericVector Min, NumericVector Max, NumericVector wts, double mfNum, double bias, double l1, double l2, double l3, double l4, double l5, double sigma, int method, NumericVector interval);
+RcppExport SEXP _ALUES_panel_score(SEXP xSEXP, SEXP monthSEXP, SEXP lagSEXP, SEXP limitsSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP wtsSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP, SEXP methodSEXP, SEXP intervalSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< NumericMatrix >::type df(dfSEXP);
-    Rcpp::traits::input_parameter< NumericMatrix >::type score(scoreSEXP);
-    Rcpp::traits::input_parameter< CharacterMatrix >::type suiClass(suiClassSEXP);
-    Rcpp::traits::input_parameter< double >::type Min(MinSEXP);
-    Rcpp::traits::input_parameter< double >::type Max(MaxSEXP);
-    Rcpp::traits::input_parameter< double >::type Mid(MidSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type x(xSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type month(monthSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type lag(lagSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type limits(limitsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type Min(MinSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type Max(MaxSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type wts(wtsSEXP);
     Rcpp::traits::input_parameter< double >::type mfNum(mfNumSEXP);
     Rcpp::traits::input_parameter< double >::type bias(biasSEXP);
-    Rcpp::traits::input_parameter< int >::type j(jSEXP);
-    Rcpp::traits::input_parameter< double >::type a(aSEXP);
-    Rcpp::traits::input_parameter< double >::type b(bSEXP);
-    Rcpp::traits::input_parameter< double >::type c(cSEXP);
-    Rcpp::traits::input_parameter< double >::type d(dSEXP);
-    Rcpp::traits::input_parameter< double >::type e(eSEXP);
-    Rcpp::traits::input_parameter< double >::type f(fSEXP);
     Rcpp::traits::input_parameter< double >::type l1(l1SEXP);
     Rcpp::traits::input_parameter< double >::type l2(l2SEXP);
     Rcpp::traits::input_parameter< double >::type l3(l3SEXP);
     Rcpp::traits::input_parameter< double >::type l4(l4SEXP);
     Rcpp::traits::input_parameter< double >::type l5(l5SEXP);
     Rcpp::traits::input_parameter< double >::type sigma(sigmaSEXP);
-    rcpp_result_gen = Rcpp::wrap(case_c(df, score, suiClass, Min, Max, Mid, mfNum, bias, j, a, b, c, d, e, f, l1, l2, l3, l4, l5, sigma));
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type interval(intervalSEXP);
+    rcpp_result_gen = Rcpp::wrap(panel_score(x, month, lag, limits, Min, Max, wts, mfNum, bias, l1, l2, l3, l4, l5, sigma, method, interval));
     return rcpp_result_gen;
 END_RCPP
 }
-// case_d
-List case_d(NumericMatrix df, NumericMatrix score, CharacterMatrix suiClass, double Min, double Max, double Mid, double mfNum, double bias, int j, double a, double b, double c, double d, double l1, double l2, double l3, double l4, double l5, double sigma);
-RcppExport SEXP _ALUES_case_d(SEXP dfSEXP, SEXP scoreSEXP, SEXP suiClassSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP MidSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP jSEXP, SEXP aSEXP, SEXP bSEXP, SEXP cSEXP, SEXP dSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP) {
+// requirement_score
+List requirement_score(NumericMatrix x, NumericMatrix limits, NumericVector minimum, NumericVector maximum, bool minAverage, bool maxAverage, double mfNum, double bias, double l1, double l2, double l3, double l4, double l5, double sigma);
+RcppExport SEXP _ALUES_requirement_score(SEXP xSEXP, SEXP limitsSEXP, SEXP minimumSEXP, SEXP maximumSEXP, SEXP minAverageSEXP, SEXP maxAverageSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< NumericMatrix >::type df(dfSEXP);
-    Rcpp::traits::input_parameter< NumericMatrix >::type score(scoreSEXP);
-    Rcpp::traits::input_parameter< CharacterMatrix >::type suiClass(suiClassSEXP);
-    Rcpp::traits::input_parameter< double >::type Min(MinSEXP);
-    Rcpp::traits::input_parameter< double >::type Max(MaxSEXP);
-    Rcpp::traits::input_parameter< double >::type Mid(MidSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type limits(limitsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type minimum(minimumSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type maximum(maximumSEXP);
+    Rcpp::traits::input_parameter< bool >::type minAverage(minAverageSEXP);
+    Rcpp::traits::input_parameter< bool >::type maxAverage(maxAverageSEXP);
     Rcpp::traits::input_parameter< double >::type mfNum(mfNumSEXP);
     Rcpp::traits::input_parameter< double >::type bias(biasSEXP);
-    Rcpp::traits::input_parameter< int >::type j(jSEXP);
-    Rcpp::traits::input_parameter< double >::type a(aSEXP);
-    Rcpp::traits::input_parameter< double >::type b(bSEXP);
-    Rcpp::traits::input_parameter< double >::type c(cSEXP);
-    Rcpp::traits::input_parameter< double >::type d(dSEXP);
     Rcpp::traits::input_parameter< double >::type l1(l1SEXP);
     Rcpp::traits::input_parameter< double >::type l2(l2SEXP);
     Rcpp::traits::input_parameter< double >::type l3(l3SEXP);
     Rcpp::traits::input_parameter< double >::type l4(l4SEXP);
     Rcpp::traits::input_parameter< double >::type l5(l5SEXP);
     Rcpp::traits::input_parameter< double >::type sigma(sigmaSEXP);
-    rcpp_result_gen = Rcpp::wrap(case_d(df, score, suiClass, Min, Max, Mid, mfNum, bias, j, a, b, c, d, l1, l2, l3, l4, l5, sigma));
+    rcpp_result_gen = Rcpp::wrap(requirement_score(x, limits, minimum, maximum, minAverage, maxAverage, mfNum, bias, l1, l2, l3, l4, l5, sigma));
     return rcpp_result_gen;
 END_RCPP
 }
-// case_e
-List case_e(NumericMatrix df, NumericMatrix score, CharacterMatrix suiClass, double Min, double Max, double Mid, double mfNum, double bias, int j, double a, double b, double c, double l1, double l2, double l3, double l4, double l5, double sigma);
-RcppExport SEXP _ALUES_case_e(SEXP dfSEXP, SEXP scoreSEXP, SEXP suiClassSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP MidSEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP jSEXP, SEXP aSEXP, SEXP bSEXP, SEXP cSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP) {
+// uncertainty_score
+List uncertainty_score(NumericMatrix x, NumericMatrix limits, NumericVector Min, NumericVector Max, NumericVector wts, IntegerVector errType, NumericVector errP1, NumericVector errP2, double mfNum, double bias, double l1, double l2, double l3, double l4, double l5, double sigma, int method, NumericVector interval, int samples, double seed, int threads);
+RcppExport SEXP _ALUES_uncertainty_score(SEXP xSEXP, SEXP limitsSEXP, SEXP MinSEXP, SEXP MaxSEXP, SEXP wtsSEXP, SEXP errTypeSEXP, SEXP errP1SEXP, SEXP errP2SEXP, SEXP mfNumSEXP, SEXP biasSEXP, SEXP l1SEXP, SEXP l2SEXP, SEXP l3SEXP, SEXP l4SEXP, SEXP l5SEXP, SEXP sigmaSEXP, SEXP methodSEXP, SEXP intervalSEXP, SEXP samplesSEXP, SEXP seedSEXP, SEXP threadsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< NumericMatrix >::type df(dfSEXP);
-    Rcpp::traits::input_parameter< NumericMatrix >::type score(scoreSEXP);
-    Rcpp::traits::input_parameter< CharacterMatrix >::type suiClass(suiClassSEXP);
-    Rcpp::traits::input_parameter< double >::type Min(MinSEXP);
-    Rcpp::traits::input_parameter< double >::type Max(MaxSEXP);
-    Rcpp::traits::input_parameter< double >::type Mid(MidSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< NumericMatrix >::type limits(limitsSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type Min(MinSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type Max(MaxSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type wts(wtsSEXP);
+    Rcpp::traits::input_parameter< IntegerVector >::type errType(errTypeSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type errP1(errP1SEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type errP2(errP2SEXP);
     Rcpp::traits::input_parameter< double >::type mfNum(mfNumSEXP);
     Rcpp::traits::input_parameter< double >::type bias(biasSEXP);
-    Rcpp::traits::input_parameter< int >::type j(jSEXP);
-    Rcpp::traits::input_parameter< double >::type a(aSEXP);
-    Rcpp::traits::input_parameter< double >::type b(bSEXP);
-    Rcpp::traits::input_parameter< double >::type c(cSEXP);
     Rcpp::traits::input_parameter< double >::type l1(l1SEXP);
     Rcpp::traits::input_parameter< double >::type l2(l2SEXP);
     Rcpp::traits::input_parameter< double >::type l3(l3SEXP);
     Rcpp::traits::input_parameter< double >::type l4(l4SEXP);
     Rcpp::traits::input_parameter< double >::type l5(l5SEXP);
     Rcpp::traits::input_parameter< double >::type sigma(sigmaSEXP);
-    rcpp_result_gen = Rcpp::wrap(case_e(df, score, suiClass, Min, Max, Mid, mfNum, bias, j, a, b, c, l1, l2, l3, l4, l5, sigma));
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    Rcpp::traits::input_parameter< NumericVector >::type interval(intervalSEXP);
+    Rcpp::traits::input_parameter< int >::type samples(samplesSEXP);
+    Rcpp::traits::input_parameter< double >::type seed(seedSEXP);
+    Rcpp::traits::input_parameter< int >::type threads(threadsSEXP);
+    rcpp_result_gen = Rcpp::wrap(uncertainty_score(x, limits, Min, Max, wts, errType, errP1, errP2, mfNum, bias, l1, l2, l3, l4, l5, sigma, method, interval, samples, seed, threads));
     return rcpp_result_gen;
 END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_ALUES_case_a", (DL_FUNC) &_ALUES_case_a, 17},
-    {"_ALUES_case_b", (DL_FUNC) &_ALUES_case_b, 17},
-    {"_ALUES_case_c", (DL_FUNC) &_ALUES_case_c, 21},
-    {"_ALUES_case_d", (DL_FUNC) &_ALUES_case_d, 19},
-    {"_ALUES_case_e", (DL_FUNC) &_ALUES_case_e, 18},
+    {"_ALUES_overall_score", (DL_FUNC) &_ALUES_overall_score, 4},
+    {"_ALUES_panel_score", (DL_FUNC) &_ALUES_panel_score, 17},
+    {"_ALUES_requirement_score", (DL_FUNC) &_ALUES_requirement_score, 14},
+    {"_ALUES_uncertainty_score", (DL_FUNC) &_ALUES_uncertainty_score, 21},
     {NULL, NULL, 0}
 };
 
@@ -0,0 +1,929 @@
+#include <cmath>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "alues_core.h"
+using namespace std;
+
+static const double default_interval[5] = {0, 0.25, 0.5, 0.75, 1};
+
+// Scoring engine shared by the Rcpp exports and the standalone library. The
+// membership functions below are split by the face of the MF that applies to
+// a factor, see the ALUES_CASE_* shapes in alues_core.h.
+
+// The following implements the Right Face of all MFs
+static void case_a(const alues_factor *fac, const alues_options *opt, const double *x, int n,
+                   double *score, int *cls) {
+  int i, mf = opt->mf, bias = opt->bias;
+  double Min = fac->min, Max = fac->max;
+  double a = fac->a, b = fac->b, c = fac->c;
+  double l1 = opt->l[0], l2 = opt->l[1], l3 = opt->l[2], l4 = opt->l[3], l5 = opt->l[4], sigma = opt->sigma;
+
+  for (i = 0; i < n; ++i) {
+    // Triangular
+    if (mf == 1) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if (x[i] == Min) {
+        score[i] = 1; cls[i] = ALUES_S1;
+      } else if ((x[i] > Min) && (x[i] <= Max)) {
+        score[i] = (Max - x[i]) / (Max - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (Max - c) / (Max - Min); l3 = (Max - b) / (Max - Min); l4 = (Max - a) / (Max - Min); l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        // for capturing bug
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Trapezoidal
+    if (mf == 2) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] <= a)) {
+        score[i] = 1; cls[i] = ALUES_S1;
+      } else if ((x[i] > a) && (x[i] <= Max)) {
+        score[i] = (Max - x[i]) / (Max - a);
+        if (bias == 1) {
+          l1 = 0; l2 = (Max - c) / (Max - a); l3 = (Max - b) / (Max - a); l4 = l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Gaussian
+    if (mf == 3) {
+      if (x[i] < Min) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if (x[i] >= Min) {
+        score[i] = exp(-pow(((x[i] - Min) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l1 = 0; l2 = exp(-pow(((c - Min) / sigma), 2)/2.0);
+          l3 = exp(-pow(((b - Min) / sigma), 2)/2.0);
+          l4 = exp(-pow(((a - Min) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+  }
+}
+
+// The following implements the Left Face of all MFs
+static void case_b(const alues_factor *fac, const alues_options *opt, const double *x, int n,
+                   double *score, int *cls) {
+  int i, mf = opt->mf, bias = opt->bias;
+  double Min = fac->min, Max = fac->max;
+  double a = fac->a, b = fac->b, c = fac->c;
+  double l1 = opt->l[0], l2 = opt->l[1], l3 = opt->l[2], l4 = opt->l[3], l5 = opt->l[4], sigma = opt->sigma;
+
+  for (i = 0; i < n; ++i) {
+    // Triangular
+    if (mf == 1) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] <= Max)) {
+        score[i] = (x[i] - Min) / (Max - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (Max - Min); l3 = (b - Min) / (Max - Min); l4 = (c - Min) / (Max - Min); l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        // to capture bug
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Trapezoidal
+    if (mf == 2) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] < c)) {
+        score[i] = (x[i] - Min) / (c - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (c - Min); l3 = (b - Min) / (c - Min);  l4 = l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] >= c) && (x[i] <= Max)) {
+        score[i] = 1; cls[i] = ALUES_S1;
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Gaussian
+    if (mf == 3) {
+      if (x[i] > Max) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if (x[i] <= Max) {
+        score[i] = exp(-pow(((x[i] - Max) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l1 = 0; l2 = exp(-pow(((a - Max) / sigma), 2)/2.0);
+          l3 = exp(-pow(((b - Max) / sigma), 2)/2.0);
+          l4 = exp(-pow(((c - Max) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+  }
+}
+
+// The following implements the Full Face of all MFs
+static void case_c(const alues_factor *fac, const alues_options *opt, const double *x, int n,
+                   double *score, int *cls) {
+  int i, mf = opt->mf, bias = opt->bias;
+  double Min = fac->min, Max = fac->max, Mid = fac->mid;
+  double a = fac->a, b = fac->b, c = fac->c, d = fac->d, e = fac->e, f = fac->f;
+  double l1 = opt->l[0], l2 = opt->l[1], l3 = opt->l[2], l4 = opt->l[3], l5 = opt->l[4], sigma = opt->sigma;
+
+  for (i = 0; i < n; ++i) {
+    // Triangular
+    if (mf == 1) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] <= Mid)) {
+        score[i] = (x[i] - Min) / (Mid - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (Mid - Min); l3 = (b - Min) / (Mid - Min); l4 = (c - Min) / (Mid - Min); l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] > Mid) && (x[i] <= Max)) {
+        score[i] = (Max - x[i]) / (Max - Mid);
+        if (bias == 1) {
+          l1 = 0; l2 = (Max - f) / (Max - Mid); l3 = (Max - e) / (Max - Mid); l4 = (Max - d) / (Max - Mid); l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        // for capturing bug
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Trapezoidal
+    if (mf == 2) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] < c)) {
+        score[i] = (x[i] - Min) / (c - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (c - Min); l3 = (b - Min) / (c - Min);  l4 = l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] >= c) && (x[i] <= d)) {
+        score[i] = 1; cls[i] = ALUES_S1;
+      } else if ((x[i] > d) && (x[i] <= Max)) {
+        score[i] = (Max - x[i]) / (Max - d);
+        if (bias == 1) {
+          l1 = 0; l2 = (Max - f) / (Max - d); l3 = (Max - e) / (Max - d); l4 = l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Gaussian
+    if (mf == 3) {
+      if (x[i] <= Mid) {
+        score[i] = exp(- pow(((x[i] - Mid) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l1 = 0; l2 = exp(- pow(((a - Mid) / sigma), 2)/2.0);
+          l3 = exp(- pow(((b - Mid) / sigma), 2)/2.0);
+          l4 = exp(- pow(((c - Mid) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if (x[i] > Mid) {
+        score[i] = exp(- pow(((x[i] - Mid) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l1 = 0; l2 = exp(- pow(((f - Mid) / sigma), 2)/2.0);
+          l3 = exp(- pow(((e - Mid) / sigma), 2)/2.0);
+          l4 = exp(- pow(((d - Mid) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+  }
+}
+
+// The following implements the cases where there are only 5 specified class limits
+static void case_d(const alues_factor *fac, const alues_options *opt, const double *x, int n,
+                   double *score, int *cls) {
+  int i, mf = opt->mf, bias = opt->bias;
+  double Min = fac->min, Max = fac->max, Mid = fac->mid;
+  double a = fac->a, b = fac->b, c = fac->c, d = fac->d;
+  double l1 = opt->l[0], l2 = opt->l[1], l3 = opt->l[2], l4 = opt->l[3], l5 = opt->l[4], sigma = opt->sigma;
+
+  for (i = 0; i < n; ++i) {
+    // Triangular
+    if (mf == 1) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] <= Mid)) {
+        score[i] = (x[i] - Min) / (Mid - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (Mid - Min); l3 = (b - Min) / (Mid - Min); l4 = (c - Min) / (Mid - Min); l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] > Mid) && (x[i] <= Max)) {
+        if (bias == 1) {
+          l3 = 0; l4 = (Max - d) / (Max - Mid); l5 = 1;
+        }
+        score[i] = (Max - x[i]) / (Max - Mid);
+        if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_N;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Trapezoidal
+    if (mf == 2) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] < c)) {
+        score[i] = (x[i] - Min) / (c - Min);
+        if (bias == 0) {
+          l1 = 0; l2 = 0.25; l3 = 0.5; l4 = 0.74; l5 = 1;
+        } else if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (c - Min); l3 = (b - Min) / (c - Min);  l4 = l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] >= c) && (x[i] <= d)) {
+        score[i] = 1; cls[i] = ALUES_S1;
+      } else if ((x[i] > d) && (x[i] <= Max)) {
+        if (bias == 1) {
+          l3 = 0; l4 = 1;
+        }
+        score[i] = (Max - x[i]) / (Max - d);
+        if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_N;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Gaussian
+    if (mf == 3) {
+      if (x[i] <= Mid) {
+        score[i] = exp(- pow(((x[i] - Mid) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l1 = 0; l2 = exp(- pow(((a - Mid) / sigma), 2)/2.0);
+          l3 = exp(- pow(((b - Mid) / sigma), 2)/2.0);
+          l4 = exp(- pow(((c - Mid) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if (x[i] > Mid) {
+        score[i] = exp(- pow(((x[i] - Mid) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l3 = exp(- pow(((Max - Mid) / sigma), 2)/2.0);
+          l4 = exp(- pow(((d - Mid) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_N;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+  }
+}
+
+// The following implements the cases where there are only 4 specified class limits
+static void case_e(const alues_factor *fac, const alues_options *opt, const double *x, int n,
+                   double *score, int *cls) {
+  int i, mf = opt->mf, bias = opt->bias;
+  double Min = fac->min, Max = fac->max, Mid = fac->mid;
+  double a = fac->a, b = fac->b, c = fac->c;
+  double l1 = opt->l[0], l2 = opt->l[1], l3 = opt->l[2], l4 = opt->l[3], l5 = opt->l[4], sigma = opt->sigma;
+
+  for (i = 0; i < n; ++i) {
+    // Triangular
+    if (mf == 1) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] <= Mid)) {
+        score[i] = (x[i] - Min) / (Mid - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (Mid - Min); l3 = (b - Min) / (Mid - Min); l4 = (c - Min) / (Mid - Min); l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] > Mid) && (x[i] <= Max)) {
+        if (bias == 1) {
+          l4 = 0; l5 = 1;
+        }
+        score[i] = (Max - x[i]) / (Max - Mid);
+        if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_N;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+    // Trapezoidal
+    if (mf == 2) {
+      if ((x[i] < Min) || (x[i] > Max)) {
+        score[i] = 0; cls[i] = ALUES_N;
+      } else if ((x[i] >= Min) && (x[i] < c)) {
+        score[i] = (x[i] - Min) / (c - Min);
+        if (bias == 1) {
+          l1 = 0; l2 = (a - Min) / (c - Min); l3 = (b - Min) / (c - Min);  l4 = l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if ((x[i] >= c) && (x[i] <= Max)) {
+        score[i] = 1; cls[i] = ALUES_S1;
+      } else {
+        cls[i] = ALUES_NA;
+      }
+    }
+    // Gaussian
+    if (mf == 3) {
+      if (x[i] <= Mid) {
+        score[i] = exp(- pow(((x[i] - Mid) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l1 = 0; l2 = exp(- pow(((a - Mid) / sigma), 2)/2.0);
+          l3 = exp(- pow(((b - Mid) / sigma), 2)/2.0);
+          l4 = exp(- pow(((c - Mid) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l1) && (score[i] < l2)) {
+          cls[i] = ALUES_N;
+        } else if ((score[i] >= l2) && (score[i] < l3)) {
+          cls[i] = ALUES_S3;
+        } else if ((score[i] >= l3) && (score[i] < l4)) {
+          cls[i] = ALUES_S2;
+        } else if (score[i] >= l4) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_NA;
+        }
+      } else if (x[i] > Mid) {
+        score[i] = exp(- pow(((x[i] - Mid) / sigma), 2)/2.0);
+        if (bias == 1) {
+          l4 = exp(- pow(((Max - Mid) / sigma), 2)/2.0);
+          l5 = 1;
+        }
+        if ((score[i] >= l4) && (score[i] <= l5)) {
+          cls[i] = ALUES_S1;
+        } else {
+          cls[i] = ALUES_N;
+        }
+      } else {
+        score[i] = -1; cls[i] = ALUES_NA;
+      }
+    }
+  }
+}
+
+void alues_options_init(alues_options *opt) {
+  opt->mf = ALUES_TRIANGULAR; opt->bias = 0;
+  opt->l[0] = 0; opt->l[1] = 0.25; opt->l[2] = 0.5; opt->l[3] = 0.75; opt->l[4] = 1;
+  opt->sigma = 1;
+}
+
+// Average spacing between consecutive class limits, used for "average" bounds
+static double average_step(const double *r, int n) {
+  int k;
+  double step = 0;
+
+  for (k = 1; k < n; ++k) {
+    step += r[k] - r[k - 1];
+  }
+  return step / (n - 1);
+}
+
+int alues_factor_init(alues_factor *f, const double *req, int min_mode, double minimum,
+                      int max_mode, double maximum) {
+  int k, n = 0, status = ALUES_OK;
+  double r[6], tmp;
+
+  // drop the missing limits, the remaining ones keep their order
+  for (k = 0; k < 6; ++k) {
+    if (!isnan(req[k])) {
+      r[n++] = req[k];
+    }
+  }
+
+  f->mid = NAN;
+  if (n == 3) {
+    if (r[0] > r[2]) {
+      tmp = r[0]; r[0] = r[2]; r[2] = tmp;
+      f->shape = ALUES_CASE_A;
+    } else if (r[0] < r[2]) {
+      f->shape = ALUES_CASE_B;
+    } else if (r[0] == r[1]) {
+      f->shape = ALUES_CASE_B;
+    } else {
+      return ALUES_ERR_LIMITS;
+    }
+
+    if (r[0] == r[2]) {
+      // no spacing to average over when all class limits are equal
+      if (min_mode == ALUES_BOUND_AVERAGE) {
+        f->min = 0; status |= ALUES_WARN_MIN_ZERO;
+      } else {
+        f->min = minimum;
+      }
+      if (max_mode == ALUES_BOUND_AVERAGE) {
+        f->max = r[2]; status |= ALUES_WARN_MAX_LIMIT;
+      } else {
+        f->max = maximum;
+      }
+    } else {
+      f->min = min_mode == ALUES_BOUND_AVERAGE ? r[0] - average_step(r, 3) : minimum;
+      f->max = max_mode == ALUES_BOUND_AVERAGE ? r[2] + average_step(r, 3) : maximum;
+    }
+  } else if ((n >= 4) && (n <= 6)) {
+    f->min = min_mode == ALUES_BOUND_AVERAGE ? r[0] - average_step(r, n) : minimum;
+    f->mid = (r[2] + r[3]) / 2.0;
+    if (n == 6) {
+      f->shape = ALUES_CASE_C;
+      f->max = max_mode == ALUES_BOUND_AVERAGE ? r[5] + average_step(r, 6) : maximum;
+    } else {
+      // the class limits above the optimum are incomplete, so the last one
+      // given is the maximum regardless of max_mode
+      f->shape = n == 5 ? ALUES_CASE_D : ALUES_CASE_E;
+      f->max = r[n - 1]; status |= ALUES_WARN_MAX_LIMIT;
+    }
+  } else {
+    return ALUES_ERR_LIMITS;
+  }
+
+  f->a = f->b = f->c = f->d = f->e = f->f = NAN;
+  if (n > 0) f->a = r[0];
+  if (n > 1) f->b = r[1];
+  if (n > 2) f->c = r[2];
+  if (n > 3) f->d = r[3];
+  if (n > 4) f->e = r[4];
+  if (n > 5) f->f = r[5];
+  return status;
+}
+
+int alues_score(const alues_factor *f, const alues_options *opt, const double *x, int n,
+                double *score, int *cls) {
+  if ((opt->mf < ALUES_TRIANGULAR) || (opt->mf > ALUES_GAUSSIAN)) {
+    return ALUES_ERR_ARGS;
+  }
+
+  switch (f->shape) {
+  case ALUES_CASE_A: case_a(f, opt, x, n, score, cls); break;
+  case ALUES_CASE_B: case_b(f, opt, x, n, score, cls); break;
+  case ALUES_CASE_C: case_c(f, opt, x, n, score, cls); break;
+  case ALUES_CASE_D: case_d(f, opt, x, n, score, cls); break;
+  case ALUES_CASE_E: case_e(f, opt, x, n, score, cls); break;
+  default: return ALUES_ERR_LIMITS;
+  }
+  return ALUES_OK;
+}
+
+static int overall_class(double x, const double *l) {
+  if ((x >= l[0]) && (x < l[1])) return ALUES_N;
+  if ((x >= l[1]) && (x < l[2])) return ALUES_S3;
+  if ((x >= l[2]) && (x < l[3])) return ALUES_S2;
+  if ((x >= l[3]) && (x <= l[4])) return ALUES_S1;
+  return ALUES_NA;
+}
+
+// Factors without weight are given one more than the largest weight, then
+// the weights are inverted so that lower values weigh more. w is left empty
+// when the plain mean applies.
+static void overall_weights(const double *wts, int ncol, int method, vector<double> &w) {
+  int k;
+  double wmax = -INFINITY;
+  long double acc = 0, wsum = 0;
+
+  w.clear();
+  if ((method != ALUES_AVERAGE) || (wts == NULL)) return;
+  for (k = 0; k < ncol; ++k) {
+    if (!isnan(wts[k]) && (wts[k] > wmax)) wmax = wts[k];
+  }
+  if (wmax == -INFINITY) return;
+
+  w.resize(ncol);
+  for (k = 0; k < ncol; ++k) {
+    w[k] = isnan(wts[k]) ? wmax + 1 : wts[k]; wsum += w[k];
+  }
+  for (k = 0; k < ncol; ++k) {
+    w[k] = (double) (wsum - w[k]); acc += w[k];
+  }
+  for (k = 0; k < ncol; ++k) {
+    w[k] = (double) (w[k] / acc);
+  }
+}
+
+// Overall score of one land unit, whose factor scores are stride apart
+static double overall_row(const double *row, size_t stride, int ncol, int method, const vector<double> &w) {
+  int k, m = 0;
+  double v;
+  long double acc = 0;
+
+  if (method == ALUES_MINIMUM) {
+    v = INFINITY;
+    for (k = 0; k < ncol; ++k) {
+      if (row[k * stride] < v) v = row[k * stride];
+    }
+  } else if (method == ALUES_MAXIMUM) {
+    v = -INFINITY;
+    for (k = 0; k < ncol; ++k) {
+      if (row[k * stride] > v) v = row[k * stride];
+    }
+  } else if (w.empty()) {
+    for (k = 0; k < ncol; ++k) {
+      if (!isnan(row[k * stride])) {
+        acc += row[k * stride]; ++m;
+      }
+    }
+    v = (double) (acc / m);
+  } else {
+    for (k = 0; k < ncol; ++k) {
+      v = row[k * stride] * w[k];
+      if (!isnan(v)) acc += v;
+    }
+    v = (double) acc;
+  }
+  return v;
+}
+
+// Lowest and second lowest scores of one land unit, k1 and k2 are their
+// factors or -1 when fewer factors are scored. Ties go to the first factor,
+// as in which.min. Returns the lowest score, as overall_row does for minimum.
+static double limiting_row(const double *row, size_t stride, int ncol, int &k1, int &k2, double &v2) {
+  int k;
+  double v, v1 = INFINITY;
+
+  k1 = k2 = -1; v2 = INFINITY;
+  for (k = 0; k < ncol; ++k) {
+    v = row[k * stride];
+    if (isnan(v)) continue;
+    if ((k1 < 0) || (v < v1)) {
+      k2 = k1; v2 = v1; k1 = k; v1 = v;
+    } else if ((k2 < 0) || (v < v2)) {
+      k2 = k; v2 = v;
+    }
+  }
+  return v1;
+}
+
+int alues_overall(const double *score, int nrow, int ncol, const double *wts, int method,
+                  const double *interval, double *out_score, int *out_class) {
+  return alues_overall_limiting(score, nrow, ncol, wts, method, interval, out_score, out_class, NULL, NULL, NULL);
+}
+
+int alues_overall_limiting(const double *score, int nrow, int ncol, const double *wts, int method,
+                           const double *interval, double *out_score, int *out_class,
+                           int *first, int *second, double *margin) {
+  const double *l = interval != NULL ? interval : default_interval;
+  vector<double> w;
+  int i, k1, k2;
+  double v1, v2;
+
+  if ((method < ALUES_MINIMUM) || (method > ALUES_AVERAGE)) {
+    return ALUES_ERR_ARGS;
+  }
+
+  overall_weights(wts, ncol, method, w);
+  for (i = 0; i < nrow; ++i) {
+    if (first == NULL) {
+      out_score[i] = overall_row(score + i, (size_t) nrow, ncol, method, w);
+    } else {
+      // the scan for the limiting factors gives the minimum for free
+      v1 = limiting_row(score + i, (size_t) nrow, ncol, k1, k2, v2);
+      out_score[i] = method == ALUES_MINIMUM ? v1 : overall_row(score + i, (size_t) nrow, ncol, method, w);
+      first[i] = k1;
+      if (second != NULL) second[i] = k2;
+      if (margin != NULL) margin[i] = k2 < 0 ? NAN : v2 - v1;
+    }
+    out_class[i] = overall_class(out_score[i], l);
+  }
+  return ALUES_OK;
+}
+
+// splitmix64, small and fast enough to give each land unit its own stream
+struct alues_rng {
+  uint64_t state;
+  int cached;
+  double spare;
+};
+
+static uint64_t rng_next(alues_rng &r) {
+  uint64_t z = (r.state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+// uniform on (0, 1]
+static double rng_unif(alues_rng &r) {
+  return ((rng_next(r) >> 11) + 1) * (1.0 / 9007199254740992.0);
+}
+
+// standard normal by Box-Muller, keeping the second draw for the next call
+static double rng_norm(alues_rng &r) {
+  double rad, theta;
+  if (r.cached) {
+    r.cached = 0;
+    return r.spare;
+  }
+  rad = sqrt(-2.0 * log(rng_unif(r))); theta = 6.283185307179586 * rng_unif(r);
+  r.spare = rad * sin(theta); r.cached = 1;
+  return rad * cos(theta);
+}
+
+int alues_uncertainty(const alues_factor *f, const alues_error *err, int m, const alues_options *opt,
+                      const double *x, int n, const double *wts, int method, const double *interval,
+                      int samples, uint64_t seed, int threads, double *freq, double *mean, double *var) {
+  const double *l = interval != NULL ? interval : default_interval;
+  vector<double> w;
+  int i;
+
+  if ((method < ALUES_MINIMUM) || (method > ALUES_AVERAGE) ||
+      (opt->mf < ALUES_TRIANGULAR) || (opt->mf > ALUES_GAUSSIAN) || (samples < 1)) {
+    return ALUES_ERR_ARGS;
+  }
+  overall_weights(wts, m, method, w);
+  (void) threads;
+
+#ifdef _OPENMP
+  #pragma omp parallel for num_threads(threads > 0 ? threads : 1) schedule(static)
+#endif
+  for (i = 0; i < n; ++i) {
+    vector<double> score(m, NAN);
+    int k, s, cls, count[4] = {0, 0, 0, 0};
+    double v, delta, mu = 0, m2 = 0;
+    alues_rng r = {seed ^ ((uint64_t) i * 0xD1B54A32D192ED03ULL), 0, 0};
+
+    rng_next(r);
+    // factors without error are scored once
+    for (k = 0; k < m; ++k) {
+      if (err[k].type == ALUES_ERROR_NONE) {
+        alues_score(&f[k], opt, &x[(size_t) k * n + i], 1, &score[k], &cls);
+      }
+    }
+    for (s = 0; s < samples; ++s) {
+      for (k = 0; k < m; ++k) {
+        if (err[k].type == ALUES_ERROR_NONE) continue;
+        v = x[(size_t) k * n + i];
+        if (err[k].type == ALUES_ERROR_GAUSSIAN) {
+          v += err[k].p1 * rng_norm(r);
+        } else {
+          v += err[k].p1 + (err[k].p2 - err[k].p1) * rng_unif(r);
+        }
+        alues_score(&f[k], opt, &v, 1, &score[k], &cls);
+      }
+      v = overall_row(score.data(), 1, m, method, w);
+      cls = overall_class(v, l);
+      if (cls != ALUES_NA) ++count[cls];
+      // Welford's update of the mean and variance
+      delta = v - mu; mu += delta / (s + 1); m2 += delta * (v - mu);
+    }
+    for (k = 0; k < 4; ++k) {
+      freq[(size_t) k * n + i] = (double) count[k] / samples;
+    }
+    mean[i] = mu;
+    var[i] = samples > 1 ? m2 / (samples - 1) : NAN;
+  }
+  return ALUES_OK;
+}
+
+int alues_panel(const alues_factor *f, const int *month, const int *lag, int m, const alues_options *opt,
+                const double *x, int n, int years, const double *wts, int method, const double *interval,
+                double *score, int *cls, double *freq) {
+  const double *l = interval != NULL ? interval : default_interval;
+  vector<double> w, sc(m);
+  vector<int> count(4);
+  int i, k, y, yk, c;
+  size_t at;
+
+  if ((method < ALUES_MINIMUM) || (method > ALUES_AVERAGE) ||
+      (opt->mf < ALUES_TRIANGULAR) || (opt->mf > ALUES_GAUSSIAN)) {
+    return ALUES_ERR_ARGS;
+  }
+  for (k = 0; k < m; ++k) {
+    if ((month[k] < 0) || (month[k] > 11) || (lag[k] < 0)) return ALUES_ERR_ARGS;
+  }
+  overall_weights(wts, m, method, w);
+
+  for (i = 0; i < n; ++i) {
+    count.assign(4, 0);
+    for (y = 0; y < years; ++y) {
+      for (k = 0; k < m; ++k) {
+        // months past the last year of the panel are left out
+        sc[k] = NAN; yk = y + lag[k];
+        if (yk < years) {
+          alues_score(&f[k], opt, &x[(size_t) i + (size_t) n * (yk + (size_t) years * month[k])], 1, &sc[k], &c);
+        }
+      }
+      at = (size_t) y * n + i;
+      score[at] = overall_row(sc.data(), 1, m, method, w);
+      cls[at] = overall_class(score[at], l);
+      if (cls[at] != ALUES_NA) ++count[cls[at]];
+    }
+    for (k = 0; k < 4; ++k) {
+      freq[(size_t) k * n + i] = years > 0 ? (double) count[k] / years : NAN;
+    }
+  }
+  return ALUES_OK;
+}
+
+const char *alues_class_name(int cls) {
+  switch (cls) {
+  case ALUES_N: return "N";
+  case ALUES_S3: return "S3";
+  case ALUES_S2: return "S2";
+  case ALUES_S1: return "S1";
+  default: return "NA";
+  }
+}
@@ -0,0 +1,52 @@
+#ifndef ALUES_RCPP_H
+#define ALUES_RCPP_H
+
+#include <Rcpp.h>
+#include <vector>
+#include "alues_core.h"
+
+// Scores column j (1-based) of df in place of score and suiClass, this is
+// shared by the case_* exports which only differ on the shape of the factor.
+inline Rcpp::List alues_score_column(Rcpp::NumericMatrix df, Rcpp::NumericMatrix score, Rcpp::CharacterMatrix suiClass,
+                                     const alues_factor &f, const alues_options &opt, int j) {
+  int i, w = j - 1, n = df.nrow();
+  std::vector<int> cls(n, ALUES_NA);
+  Rcpp::List out(2);
+
+  alues_score(&f, &opt, df.begin() + (R_xlen_t) w * n, n, score.begin() + (R_xlen_t) w * n, cls.data());
+  for (i = 0; i < n; ++i) {
+    suiClass(i, w) = alues_class_name(cls[i]);
+  }
+  out[0] = score; out[1] = suiClass;
+  return out;
+}
+
+inline alues_options alues_rcpp_options(double mfNum, double bias, double l1, double l2, double l3, double l4, double l5,
+                                        double sigma) {
+  alues_options opt = {(int) mfNum, (int) bias, {l1, l2, l3, l4, l5}, sigma};
+  return opt;
+}
+
+// Rebuilds the factors from the class limits (factors x 6) and the bounds
+// already resolved by suitability(). Factors skipped by suitability() get
+// shape 0, so that they are left out of the scoring.
+inline std::vector<alues_factor> alues_rcpp_factors(Rcpp::NumericMatrix limits, Rcpp::NumericVector Min,
+                                                    Rcpp::NumericVector Max) {
+  int i, k, m = limits.nrow();
+  std::vector<alues_factor> fac(m);
+  double req[6];
+
+  if ((limits.ncol() != 6) || (Min.size() != m) || (Max.size() != m)) {
+    Rcpp::stop("factors' limits and bounds should have the same number of factors.");
+  }
+  for (k = 0; k < m; ++k) {
+    for (i = 0; i < 6; ++i) req[i] = limits(k, i);
+    if (ISNAN(Min[k]) || ISNAN(Max[k]) ||
+        alues_factor_init(&fac[k], req, ALUES_BOUND_FIXED, Min[k], ALUES_BOUND_FIXED, Max[k]) < 0) {
+      fac[k].shape = 0;
+    }
+  }
+  return fac;
+}
+
+#endif
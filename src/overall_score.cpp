@@ -0,0 +1,35 @@
+#include <Rcpp.h>
+#include <vector>
+#include "alues_core.h"
+using namespace Rcpp;
+
+// The following implements the aggregation of the factors' scores into the
+// overall suitability, method is one of ALUES_MINIMUM, ALUES_MAXIMUM and ALUES_AVERAGE.
+// The lowest and second lowest scoring factors are returned as 1-based column
+// indices of x, NA when there is none
+
+// [[Rcpp::export]]
+List overall_score(NumericMatrix x, NumericVector wts, int method, NumericVector interval) {
+  int i, n = x.nrow();
+  std::vector<int> cls(n, ALUES_NA);
+  NumericVector score(n), margin(n);
+  IntegerVector first(n), second(n);
+  CharacterVector suiClass(n);
+  List out(5);
+
+  if (interval.size() != 5) {
+    stop("interval should have 5 limits in ascending order from 0 to 1.");
+  }
+  if (alues_overall_limiting(x.begin(), n, x.ncol(), wts.size() == x.ncol() ? wts.begin() : NULL, method,
+                             interval.begin(), score.begin(), cls.data(), first.begin(), second.begin(),
+                             margin.begin()) != ALUES_OK) {
+    stop("method available are 'minimum', 'maximum' and 'average'.");
+  }
+  for (i = 0; i < n; ++i) {
+    suiClass[i] = alues_class_name(cls[i]);
+    first[i] = first[i] < 0 ? NA_INTEGER : first[i] + 1;
+    second[i] = second[i] < 0 ? NA_INTEGER : second[i] + 1;
+  }
+  out[0] = score; out[1] = suiClass; out[2] = first; out[3] = second; out[4] = margin;
+  return out;
+}
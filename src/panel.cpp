@@ -0,0 +1,41 @@
+#include <Rcpp.h>
+#include <vector>
+#include "alues_rcpp.h"
+using namespace Rcpp;
+
+// The following implements the scoring of a land units x years x months
+// panel of water or temperature data, month and lag locate each factor in
+// the panel and limits, Min, Max are as in uncertainty_score
+
+// [[Rcpp::export]]
+List panel_score(NumericVector x, IntegerVector month, IntegerVector lag, NumericMatrix limits, NumericVector Min,
+                 NumericVector Max, NumericVector wts, double mfNum, double bias, double l1, double l2, double l3,
+                 double l4, double l5, double sigma, int method, NumericVector interval) {
+  IntegerVector dim = x.attr("dim");
+  if ((dim.size() != 3) || (dim[2] != 12)) {
+    stop("climate data should be an array of land units x years x 12 months.");
+  }
+  int i, m = month.size(), n = dim[0], years = dim[1];
+  std::vector<alues_factor> fac = alues_rcpp_factors(limits, Min, Max);
+  alues_options opt = alues_rcpp_options(mfNum, bias, l1, l2, l3, l4, l5, sigma);
+  std::vector<int> cls((size_t) n * years, ALUES_NA);
+  NumericMatrix score(n, years), freq(n, 4);
+  CharacterMatrix suiClass(n, years);
+  List out(3);
+
+  if (interval.size() != 5) {
+    stop("interval should have 5 limits in ascending order from 0 to 1.");
+  }
+  if (((int) fac.size() != m) || (lag.size() != m)) {
+    stop("factors' months, limits and bounds should have the same number of factors.");
+  }
+  if (alues_panel(fac.data(), month.begin(), lag.begin(), m, &opt, x.begin(), n, years, wts.size() == m ? wts.begin() : NULL,
+                  method, interval.begin(), score.begin(), cls.data(), freq.begin()) != ALUES_OK) {
+    stop("months should be from 0 to 11 and method either 'minimum', 'maximum' or 'average'.");
+  }
+  for (i = 0; i < n * years; ++i) {
+    suiClass[i] = alues_class_name(cls[i]);
+  }
+  out[0] = score; out[1] = suiClass; out[2] = freq;
+  return out;
+}
@@ -0,0 +1,47 @@
+#include <Rcpp.h>
+#include <vector>
+#include "alues_rcpp.h"
+using namespace Rcpp;
+
+// The following scores the land units x against the requirements of a crop,
+// limits is the factors x 6 matrix of class limits matched with the columns
+// of x, and minimum, maximum hold one or one per factor value, ignored when
+// minAverage, maxAverage are set. The shape and bounds of every factor come
+// from alues_factor_init, the bounds are returned with its status so that the
+// warnings can be raised in R
+
+// [[Rcpp::export]]
+List requirement_score(NumericMatrix x, NumericMatrix limits, NumericVector minimum, NumericVector maximum,
+                       bool minAverage, bool maxAverage, double mfNum, double bias, double l1, double l2, double l3,
+                       double l4, double l5, double sigma) {
+  int i, k, status, m = limits.nrow(), n = x.nrow();
+  alues_options opt = alues_rcpp_options(mfNum, bias, l1, l2, l3, l4, l5, sigma);
+  NumericMatrix score(n, m), bounds(m, 3);
+  CharacterMatrix suiClass(n, m);
+  alues_factor f;
+  double req[6];
+  List out(3);
+
+  if ((limits.ncol() != 6) || (x.ncol() != m) || ((minimum.size() != 1) && (minimum.size() != m)) ||
+      ((maximum.size() != 1) && (maximum.size() != m))) {
+    stop("factors' limits, minimum and maximum should match the columns of x.");
+  }
+  std::fill(score.begin(), score.end(), NA_REAL);
+  std::fill(suiClass.begin(), suiClass.end(), NA_STRING);
+  for (k = 0; k < m; ++k) {
+    for (i = 0; i < 6; ++i) req[i] = limits(k, i);
+    status = alues_factor_init(&f, req, minAverage ? ALUES_BOUND_AVERAGE : ALUES_BOUND_FIXED, minimum[minimum.size() == 1 ? 0 : k],
+                               maxAverage ? ALUES_BOUND_AVERAGE : ALUES_BOUND_FIXED, maximum[maximum.size() == 1 ? 0 : k]);
+    bounds(k, 2) = status;
+    if (status < 0) {
+      // factors whose limits cannot be evaluated are left unscored
+      bounds(k, 0) = bounds(k, 1) = NA_REAL;
+      continue;
+    }
+    bounds(k, 0) = f.min; bounds(k, 1) = f.max;
+    alues_score_column(x, score, suiClass, f, opt, k + 1);
+  }
+  colnames(bounds) = CharacterVector::create("min", "max", "status");
+  out[0] = score; out[1] = suiClass; out[2] = bounds;
+  return out;
+}
@@ -0,0 +1,39 @@
+#include <Rcpp.h>
+#include <vector>
+#include "alues_rcpp.h"
+using namespace Rcpp;
+
+// The following implements the Monte Carlo propagation of the factors'
+// measurement error, limits is the factors x 6 matrix of class limits and
+// Min, Max are the bounds already resolved by suitability(). interval holds
+// the limits of the overall suitability classes
+
+// [[Rcpp::export]]
+List uncertainty_score(NumericMatrix x, NumericMatrix limits, NumericVector Min, NumericVector Max, NumericVector wts,
+                       IntegerVector errType, NumericVector errP1, NumericVector errP2, double mfNum, double bias,
+                       double l1, double l2, double l3, double l4, double l5, double sigma, int method,
+                       NumericVector interval, int samples, double seed, int threads) {
+  int k, m = x.ncol(), n = x.nrow();
+  std::vector<alues_factor> fac = alues_rcpp_factors(limits, Min, Max);
+  std::vector<alues_error> err(m);
+  alues_options opt = alues_rcpp_options(mfNum, bias, l1, l2, l3, l4, l5, sigma);
+  NumericMatrix freq(n, 4);
+  NumericVector mean(n), var(n);
+  List out(3);
+
+  if (interval.size() != 5) {
+    stop("interval should have 5 limits in ascending order from 0 to 1.");
+  }
+  if (((int) fac.size() != m) || (errType.size() != m) || (errP1.size() != m) || (errP2.size() != m)) {
+    stop("factors' limits, bounds and errors should match the columns of x.");
+  }
+  for (k = 0; k < m; ++k) {
+    err[k].type = errType[k]; err[k].p1 = errP1[k]; err[k].p2 = errP2[k];
+  }
+  if (alues_uncertainty(fac.data(), err.data(), m, &opt, x.begin(), n, wts.size() == m ? wts.begin() : NULL, method,
+                        interval.begin(), samples, (uint64_t) (int64_t) seed, threads, freq.begin(), mean.begin(), var.begin()) != ALUES_OK) {
+    stop("samples should be positive and method either 'minimum', 'maximum' or 'average'.");
+  }
+  out[0] = freq; out[1] = mean; out[2] = var;
+  return out;
+}
@@ -0,0 +1,97 @@
+// CSV helpers shared by the command-line tools. Files are small, comma
+// separated, with a header line; quotes around cells are stripped and empty
+// or NA cells read as missing numbers. Requirement tables follow the layout of
+// the ALUES crop datasets: code, s3_a, s2_a, s1_a, s1_b, s2_b, s3_b, wts.
+#ifndef ALUES_CSV_H
+#define ALUES_CSV_H
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "alues_core.h"
+
+struct Table {
+  std::vector<std::string> names;
+  std::vector<std::vector<std::string> > rows;
+};
+
+static inline std::string trim(const std::string &s) {
+  size_t b = s.find_first_not_of(" \t\r\""), e = s.find_last_not_of(" \t\r\"");
+  return b == std::string::npos ? "" : s.substr(b, e - b + 1);
+}
+
+static inline std::vector<std::string> split(const std::string &line) {
+  std::vector<std::string> out;
+  std::string cell;
+  std::istringstream in(line);
+  while (std::getline(in, cell, ',')) {
+    out.push_back(trim(cell));
+  }
+  if (!line.empty() && line[line.size() - 1] == ',') {
+    out.push_back("");
+  }
+  return out;
+}
+
+static inline double number(const std::string &s) {
+  char *end;
+  double x;
+  if (s.empty() || s == "NA") return NAN;
+  x = strtod(s.c_str(), &end);
+  return *end == '\0' ? x : NAN;
+}
+
+static inline bool read_csv(const char *path, Table &t) {
+  std::ifstream in(path);
+  std::string line;
+  if (!in || !std::getline(in, line)) return false;
+  t.names = split(line);
+  while (std::getline(in, line)) {
+    if (!trim(line).empty()) t.rows.push_back(split(line));
+  }
+  return true;
+}
+
+// Rows of a requirement table matched against the factors of the land units
+struct Requirements {
+  std::vector<std::string> names;     // factors evaluated, in the order of the table
+  std::vector<int> column;            // their position among the land units' factors
+  std::vector<size_t> row;            // their row in the table
+  std::vector<alues_factor> factors;  // set by init_requirements
+  std::vector<int> status;            // of alues_factor_init
+  std::vector<double> wts;
+};
+
+static inline void match_requirements(const Table &cr, const std::vector<std::string> &names, Requirements &req) {
+  for (size_t r = 0; r < cr.rows.size(); ++r) {
+    const std::vector<std::string> &row = cr.rows[r];
+    size_t col;
+    for (col = 0; col < names.size() && (row.empty() || names[col] != row[0]); ++col);
+    if (col == names.size()) continue;
+    req.names.push_back(row[0]);
+    req.column.push_back((int) col);
+    req.row.push_back(r);
+  }
+}
+
+// Shape, bounds and weight of the matched factors, those whose limits cannot
+// be evaluated are left unscored
+static inline void init_requirements(const Table &cr, int min_mode, double minimum, int max_mode, double maximum,
+                                     Requirements &req) {
+  req.factors.resize(req.row.size());
+  req.status.resize(req.row.size());
+  req.wts.resize(req.row.size());
+  for (size_t k = 0; k < req.row.size(); ++k) {
+    const std::vector<std::string> &row = cr.rows[req.row[k]];
+    double limits[6];
+    for (size_t q = 0; q < 6; ++q) limits[q] = q + 1 < row.size() ? number(row[q + 1]) : NAN;
+    req.status[k] = alues_factor_init(&req.factors[k], limits, min_mode, minimum, max_mode, maximum);
+    if (req.status[k] < 0) req.factors[k].shape = 0;
+    req.wts[k] = row.size() > 7 ? number(row[7]) : NAN;
+  }
+}
+
+#endif
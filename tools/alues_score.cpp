@@ -0,0 +1,228 @@
+// Command-line driver for the standalone ALUES library. Scores the land units
+// in a CSV file against a crop requirement CSV, without an R interpreter.
+//
+//   alues-score [options] LANDUNITS.csv REQUIREMENTS.csv
+//
+// The land units file has one column per factor, with the factor codes as
+// header. The requirement file follows the layout of the ALUES crop datasets:
+// code, s3_a, s2_a, s1_a, s1_b, s2_b, s3_b, wts with empty or NA entries for
+// missing values.
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "alues_core.h"
+#include "alues_csv.h"
+using namespace std;
+
+static void usage() {
+  cerr << "usage: alues-score [options] LANDUNITS.csv REQUIREMENTS.csv\n"
+       << "  --mf triangular|trapezoidal|gaussian  membership function (triangular)\n"
+       << "  --interval unbias|l1,l2,l3,l4,l5      class limits (0,0.25,0.5,0.75,1)\n"
+       << "  --minimum average|VALUE               factors' minimum (0)\n"
+       << "  --maximum average|VALUE               factors' maximum (average)\n"
+       << "  --sigma VALUE                         spread of the gaussian MF (1)\n"
+       << "  --method minimum|maximum|average      overall suitability (minimum)\n"
+       << "  --error FACTOR=SD|FACTOR=LOWER:UPPER  gaussian or uniform measurement error\n"
+       << "  --samples N                           Monte Carlo samples per land unit (1000)\n"
+       << "  --seed N                              seed of the Monte Carlo samples (1)\n"
+       << "  --threads N                           threads for the Monte Carlo samples (1)\n"
+       << "  --repeat N                            score N times and report timings\n"
+       << "  --quiet                               do not print the scores\n";
+}
+
+static bool parse_bound(const char *s, int &mode, double &value) {
+  if (strcmp(s, "average") == 0) {
+    mode = ALUES_BOUND_AVERAGE;
+    return true;
+  }
+  mode = ALUES_BOUND_FIXED; value = number(s);
+  return !isnan(value);
+}
+
+int main(int argc, char **argv) {
+  alues_options opt;
+  int i, k, min_mode = ALUES_BOUND_FIXED, max_mode = ALUES_BOUND_AVERAGE, method = ALUES_MINIMUM;
+  int repeat = 1, quiet = 0, samples = 1000, threads = 1;
+  unsigned long long seed = 1;
+  vector<pair<string, alues_error> > errors;
+  double minimum = 0, maximum = NAN;
+  vector<const char *> files;
+  Table lu, cr;
+
+  alues_options_init(&opt);
+  for (i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (arg == "--quiet") {
+      quiet = 1; continue;
+    }
+    if (arg.compare(0, 2, "--") != 0) {
+      files.push_back(argv[i]); continue;
+    }
+    if (i + 1 >= argc) {
+      usage(); return 1;
+    }
+    const char *val = argv[++i];
+    if (arg == "--mf") {
+      if (strcmp(val, "triangular") == 0) opt.mf = ALUES_TRIANGULAR;
+      else if (strcmp(val, "trapezoidal") == 0) opt.mf = ALUES_TRAPEZOIDAL;
+      else if (strcmp(val, "gaussian") == 0) opt.mf = ALUES_GAUSSIAN;
+      else {
+        cerr << "Unrecognized mf='" << val << "', please choose either 'triangular', 'trapezoidal' or 'gaussian'.\n";
+        return 1;
+      }
+    } else if (arg == "--interval") {
+      if (strcmp(val, "unbias") == 0) {
+        opt.bias = 1;
+      } else {
+        vector<string> l = split(val);
+        if (l.size() != 5) {
+          cerr << "interval should have 5 limits.\n";
+          return 1;
+        }
+        for (k = 0; k < 5; ++k) opt.l[k] = number(l[k]);
+      }
+    } else if (arg == "--minimum") {
+      if (!parse_bound(val, min_mode, minimum)) {
+        cerr << "Cannot identify minimum='" << val << "'.\n";
+        return 1;
+      }
+    } else if (arg == "--maximum") {
+      if (!parse_bound(val, max_mode, maximum)) {
+        cerr << "Cannot identify maximum='" << val << "'. maximum can only take 'average' or a number.\n";
+        return 1;
+      }
+    } else if (arg == "--sigma") {
+      opt.sigma = number(val);
+    } else if (arg == "--method") {
+      if (strcmp(val, "minimum") == 0) method = ALUES_MINIMUM;
+      else if (strcmp(val, "maximum") == 0) method = ALUES_MAXIMUM;
+      else if (strcmp(val, "average") == 0) method = ALUES_AVERAGE;
+      else {
+        cerr << "method available are 'minimum', 'maximum' and 'average'.\n";
+        return 1;
+      }
+    } else if (arg == "--error") {
+      // FACTOR=SD for a gaussian error, FACTOR=LOWER:UPPER for a uniform one
+      string spec = val;
+      size_t eq = spec.find('='), colon = spec.find(':');
+      alues_error e = {ALUES_ERROR_GAUSSIAN, 0, 0};
+      if (eq == string::npos) {
+        cerr << "error should be given as FACTOR=SD or FACTOR=LOWER:UPPER.\n";
+        return 1;
+      }
+      if (colon == string::npos) {
+        e.p1 = number(spec.substr(eq + 1));
+      } else {
+        e.type = ALUES_ERROR_UNIFORM;
+        e.p1 = number(spec.substr(eq + 1, colon - eq - 1)); e.p2 = number(spec.substr(colon + 1));
+      }
+      errors.push_back(make_pair(spec.substr(0, eq), e));
+    } else if (arg == "--samples") {
+      samples = atoi(val);
+    } else if (arg == "--seed") {
+      seed = strtoull(val, NULL, 10);
+    } else if (arg == "--threads") {
+      threads = atoi(val);
+    } else if (arg == "--repeat") {
+      repeat = atoi(val);
+    } else {
+      usage(); return 1;
+    }
+  }
+  if (files.size() != 2 || repeat < 1 || samples < 1) {
+    usage(); return 1;
+  }
+  if (!read_csv(files[0], lu) || !read_csv(files[1], cr)) {
+    cerr << "Cannot read input files.\n";
+    return 1;
+  }
+
+  // match the requirement rows against the land units columns
+  int n = (int) lu.rows.size();
+  Requirements req;
+  vector<double> x;
+  vector<alues_error> err;
+  match_requirements(cr, lu.names, req);
+  init_requirements(cr, min_mode, minimum, max_mode, maximum, req);
+  for (k = 0; k < (int) req.names.size(); ++k) {
+    const string &name = req.names[k];
+    int status = req.status[k];
+    if (status < 0) {
+      cerr << "warning: factor " << name << " has no class limits to evaluate.\n";
+    } else if (status & ALUES_WARN_MIN_ZERO) {
+      cerr << "warning: minimum is set to zero for factor " << name << " since all suitability class intervals are equal.\n";
+    }
+    if ((status > 0) && (status & ALUES_WARN_MAX_LIMIT)) {
+      cerr << "warning: maximum is set to " << req.factors[k].max << " for factor " << name << ".\n";
+    }
+    alues_error e = {ALUES_ERROR_NONE, 0, 0};
+    for (size_t q = 0; q < errors.size(); ++q) {
+      if (errors[q].first == name) e = errors[q].second;
+    }
+    err.push_back(e);
+    for (i = 0; i < n; ++i) {
+      size_t col = req.column[k];
+      x.push_back(col < lu.rows[i].size() ? number(lu.rows[i][col]) : NAN);
+    }
+  }
+  if (req.names.empty()) {
+    cerr << "No factor(s) to be evaluated, since none matches with the crop requirements.\n";
+    return 1;
+  }
+
+  int m = (int) req.names.size();
+  if (!errors.empty()) {
+    // uncertainty mode: class probabilities and moments of the overall score
+    vector<double> freq((size_t) n * 4), mean(n), var(n);
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    for (int rep = 0; rep < repeat; ++rep) {
+      alues_uncertainty(req.factors.data(), err.data(), m, &opt, x.data(), n, req.wts.data(), method, NULL,
+                        samples, seed, threads, freq.data(), mean.data(), var.data());
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    if (repeat > 1) {
+      fprintf(stderr, "%d land units x %d factors x %d samples, %d runs: %.6f s total, %.3f ms per run\n",
+              n, m, samples, repeat, elapsed, 1e3 * elapsed / repeat);
+    }
+    if (quiet) return 0;
+    printf("S1,S2,S3,N,Mean,Variance\n");
+    for (i = 0; i < n; ++i) {
+      printf("%.15g,%.15g,%.15g,%.15g,%.15g,%.15g\n", freq[(size_t) 3 * n + i], freq[(size_t) 2 * n + i],
+             freq[(size_t) n + i], freq[i], mean[i], var[i]);
+    }
+    return 0;
+  }
+
+  vector<double> score((size_t) n * m, NAN), overall(n), margin(n);
+  vector<int> cls((size_t) n * m, ALUES_NA), overall_cls(n), first(n), second(n);
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  for (int rep = 0; rep < repeat; ++rep) {
+    for (k = 0; k < m; ++k) {
+      alues_score(&req.factors[k], &opt, &x[(size_t) k * n], n, &score[(size_t) k * n], &cls[(size_t) k * n]);
+    }
+    alues_overall_limiting(score.data(), n, m, req.wts.data(), method, NULL, overall.data(), overall_cls.data(),
+                           first.data(), second.data(), margin.data());
+  }
+  double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+  if (repeat > 1) {
+    fprintf(stderr, "%d land units x %d factors, %d runs: %.6f s total, %.3f us per run\n",
+            n, m, repeat, elapsed, 1e6 * elapsed / repeat);
+  }
+  if (quiet) return 0;
+
+  for (k = 0; k < m; ++k) printf("%s,", req.names[k].c_str());
+  for (k = 0; k < m; ++k) printf("%s.class,", req.names[k].c_str());
+  printf("Score,Class,Limiting,Second,Margin\n");
+  for (i = 0; i < n; ++i) {
+    for (k = 0; k < m; ++k) printf("%.15g,", score[(size_t) k * n + i]);
+    for (k = 0; k < m; ++k) printf("%s,", alues_class_name(cls[(size_t) k * n + i]));
+    printf("%.15g,%s,%s,%s,%.15g\n", overall[i], alues_class_name(overall_cls[i]),
+           first[i] < 0 ? "NA" : req.names[first[i]].c_str(), second[i] < 0 ? "NA" : req.names[second[i]].c_str(), margin[i]);
+  }
+  return 0;
+}
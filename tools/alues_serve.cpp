@@ -0,0 +1,698 @@
+// Resident scoring service for the standalone ALUES library. Crop requirement
+// tables are read once from a directory and kept in memory, and requests that
+// arrive together for the same crop and settings are scored in one batch.
+//
+//   alues-serve [options] CROPDIR
+//
+// The protocol is one JSON object per line, on stdin/stdout or on a local Unix
+// socket. A scoring request names a requirement table CROPDIR/<crop>.csv, the
+// factors of the land units and one row of values per land unit:
+//
+//   {"id": 1, "crop": "BANANASoil", "factors": ["pHH2O", "CFragm"], "units": [[5.5, 10], [7.2, 40]]}
+//
+// A null value is missing and, as NA in suit(), scores -1 for that factor. The
+// optional settings "mf", "interval", "minimum", "maximum", "sigma"
+// and "method" taking the same values as the alues-score options. The reply
+// carries the same id, the factors evaluated and, per land unit, the overall
+// score, class and limiting factor:
+//
+//   {"id": 1, "factors": ["CFragm", "pHH2O"], "score": [...], "class": [...], "limiting": [...]}
+//
+// {"op": "stats"} replies with the request latency percentiles, and
+// {"op": "reload"} drops the cached requirement tables. Requests are limited
+// to 16 MiB per line.
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "alues_core.h"
+#include "alues_csv.h"
+using namespace std;
+typedef chrono::steady_clock Clock;
+
+static void usage() {
+  cerr << "usage: alues-serve [options] CROPDIR\n"
+       << "  --socket PATH   listen on a Unix socket instead of stdin/stdout\n"
+       << "  --window US     wait US microseconds for more requests before scoring (0)\n";
+}
+
+// Minimal JSON reader, enough for the requests of this protocol
+struct Json {
+  enum { NUL, BOOL, NUM, STR, ARR, OBJ } type;
+  double num;
+  string str;
+  vector<Json> arr;
+  vector<pair<string, Json> > obj;
+
+  Json() : type(NUL), num(0) {}
+  const Json *get(const char *key) const {
+    for (size_t k = 0; k < obj.size(); ++k) {
+      if (obj[k].first == key) return &obj[k].second;
+    }
+    return NULL;
+  }
+};
+
+static void skip_space(const char *&p) {
+  while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') ++p;
+}
+
+static bool parse_string(const char *&p, string &out) {
+  if (*p++ != '"') return false;
+  for (; *p != '"'; ++p) {
+    if (*p == '\0') return false;
+    if (*p == '\\') {
+      ++p;
+      switch (*p) {
+      case 'n': out += '\n'; break;
+      case 't': out += '\t'; break;
+      case 'r': out += '\r'; break;
+      case 'b': out += '\b'; break;
+      case 'f': out += '\f'; break;
+      case 'u': {
+        // factor and crop names are ASCII, other code points are dropped
+        char *end;
+        long c = strtol(string(p + 1, strnlen(p + 1, 4)).c_str(), &end, 16);
+        if (*end != '\0' || strnlen(p + 1, 4) != 4) return false;
+        if (c < 0x80) out += (char) c;
+        p += 4;
+        break;
+      }
+      case '\0': return false;
+      default: out += *p;
+      }
+    } else {
+      out += *p;
+    }
+  }
+  ++p;
+  return true;
+}
+
+static bool parse_json(const char *&p, Json &out, int depth = 0) {
+  if (depth > 32) return false;
+  skip_space(p);
+  if (*p == '{') {
+    out.type = Json::OBJ; ++p; skip_space(p);
+    if (*p == '}') {
+      ++p; return true;
+    }
+    for (;;) {
+      pair<string, Json> kv;
+      skip_space(p);
+      if (!parse_string(p, kv.first)) return false;
+      skip_space(p);
+      if (*p++ != ':' || !parse_json(p, kv.second, depth + 1)) return false;
+      out.obj.push_back(kv);
+      skip_space(p);
+      if (*p == ',') {
+        ++p; continue;
+      }
+      return *p++ == '}';
+    }
+  } else if (*p == '[') {
+    out.type = Json::ARR; ++p; skip_space(p);
+    if (*p == ']') {
+      ++p; return true;
+    }
+    for (;;) {
+      out.arr.push_back(Json());
+      if (!parse_json(p, out.arr.back(), depth + 1)) return false;
+      skip_space(p);
+      if (*p == ',') {
+        ++p; continue;
+      }
+      return *p++ == ']';
+    }
+  } else if (*p == '"') {
+    out.type = Json::STR;
+    return parse_string(p, out.str);
+  } else if (strncmp(p, "null", 4) == 0) {
+    out.type = Json::NUL; p += 4;
+    return true;
+  } else if (strncmp(p, "true", 4) == 0 || strncmp(p, "false", 5) == 0) {
+    out.type = Json::BOOL; out.num = *p == 't'; p += *p == 't' ? 4 : 5;
+    return true;
+  }
+  char *end;
+  out.type = Json::NUM; out.num = strtod(p, &end);
+  if (end == p) return false;
+  p = end;
+  return true;
+}
+
+static string quote(const string &s) {
+  string out = "\"";
+  for (size_t k = 0; k < s.size(); ++k) {
+    if (s[k] == '"' || s[k] == '\\') out += '\\';
+    if ((unsigned char) s[k] < 0x20) continue;
+    out += s[k];
+  }
+  return out + "\"";
+}
+
+static string format_number(double x) {
+  char buf[32];
+  if (!isfinite(x)) return "null";
+  snprintf(buf, sizeof buf, "%.15g", x);
+  return buf;
+}
+
+// Scoring settings resolved against a crop table, shared by all the requests
+// with the same crop, settings and set of factors evaluated, whatever the
+// order of the factors in the request
+struct Model {
+  Requirements req;
+  alues_options opt;
+  int method;
+};
+
+// A connection, replies are written whole lines at a time
+struct Sink {
+  int fd;
+  mutex lock;
+  int inflight;
+  condition_variable idle;
+
+  explicit Sink(int fd) : fd(fd), inflight(0) {}
+  void write_line(const string &line) {
+    lock_guard<mutex> guard(lock);
+    const char *p = line.c_str();
+    size_t left = line.size();
+    while (left > 0) {
+      ssize_t k = fd == STDOUT_FILENO ? write(fd, p, left) : send(fd, p, left, MSG_NOSIGNAL);
+      if (k < 0 && errno == EINTR) continue;
+      if (k <= 0) return;
+      p += k; left -= k;
+    }
+  }
+  void finish() {
+    lock_guard<mutex> guard(lock);
+    if (--inflight == 0) idle.notify_all();
+  }
+};
+
+struct Job {
+  shared_ptr<Sink> sink;
+  shared_ptr<const Model> model;
+  string id;          // the request's id, already as JSON
+  int n;              // land units
+  vector<int> column; // position of the model's factors in the request
+  vector<double> x;   // n x factors, column-major in the order of the model
+  Clock::time_point start;
+};
+
+// Latencies of the last requests, from the line being read to the reply
+struct Stats {
+  mutex lock;
+  vector<double> latency;
+  size_t next;
+  long long requests, batches;
+
+  Stats() : latency(), next(0), requests(0), batches(0) {}
+  void add(double us) {
+    lock_guard<mutex> guard(lock);
+    if (latency.size() < 65536) {
+      latency.push_back(us);
+    } else {
+      latency[next] = us; next = (next + 1) % latency.size();
+    }
+    ++requests;
+  }
+  string json() {
+    lock_guard<mutex> guard(lock);
+    vector<double> v(latency);
+    static const double p[] = {0.5, 0.9, 0.99, 1};
+    static const char *name[] = {"p50", "p90", "p99", "max"};
+    ostringstream out;
+    sort(v.begin(), v.end());
+    out << "{\"requests\": " << requests << ", \"batches\": " << batches << ", \"latency_us\": {";
+    for (int k = 0; k < 4; ++k) {
+      size_t at = (size_t) ceil(p[k] * v.size());
+      out << (k > 0 ? ", " : "") << "\"" << name[k] << "\": " << (v.empty() ? "null" : format_number(v[at > 0 ? at - 1 : 0]));
+    }
+    out << "}}";
+    return out.str();
+  }
+};
+
+static const size_t max_line = 1 << 24;  // longest request, in bytes
+static string crop_dir;
+static long window_us = 0;
+static Stats stats;
+static mutex cache_lock;
+static map<string, shared_ptr<const Table> > crops;
+static map<string, shared_ptr<const Model> > models;
+static unsigned long generation = 0;  // bumped by reload, under cache_lock
+static mutex queue_lock;
+static condition_variable queue_ready;
+static vector<Job *> queue;
+static bool stopping = false;           // no more jobs are queued, under queue_lock
+static mutex conn_lock;
+static condition_variable conn_done;
+static int connections = 0;             // socket connections still being served
+// Self-pipe written by the signal handler, whichever thread runs it. It is
+// never drained, so every poll on it wakes up once a shutdown is requested.
+static int wake[2] = {-1, -1};
+
+static void on_signal(int) {
+  int saved = errno;
+  if (write(wake[1], "x", 1) < 0) {
+    // nothing to do, the pipe is already readable
+  }
+  errno = saved;
+}
+
+static bool parse_options(const Json &req, alues_options &opt, int &method, int &min_mode, double &minimum,
+                          int &max_mode, double &maximum, string &err) {
+  const Json *v;
+  alues_options_init(&opt);
+  method = ALUES_MINIMUM; min_mode = ALUES_BOUND_FIXED; minimum = 0; max_mode = ALUES_BOUND_AVERAGE; maximum = NAN;
+  if ((v = req.get("mf")) != NULL) {
+    if (v->str == "triangular") opt.mf = ALUES_TRIANGULAR;
+    else if (v->str == "trapezoidal") opt.mf = ALUES_TRAPEZOIDAL;
+    else if (v->str == "gaussian") opt.mf = ALUES_GAUSSIAN;
+    else {
+      err = "Unrecognized mf, please choose either 'triangular', 'trapezoidal' or 'gaussian'."; return false;
+    }
+  }
+  if ((v = req.get("interval")) != NULL) {
+    if (v->type == Json::STR && v->str == "unbias") {
+      opt.bias = 1;
+    } else if (v->type == Json::ARR && v->arr.size() == 5) {
+      for (int k = 0; k < 5; ++k) opt.l[k] = v->arr[k].type == Json::NUM ? v->arr[k].num : NAN;
+    } else {
+      err = "interval should be 'unbias' or have 5 limits."; return false;
+    }
+  }
+  if ((v = req.get("minimum")) != NULL) {
+    if (v->type == Json::STR && v->str == "average") min_mode = ALUES_BOUND_AVERAGE;
+    else if (v->type == Json::NUM) minimum = v->num;
+    else {
+      err = "minimum can only take 'average' or a number."; return false;
+    }
+  }
+  if ((v = req.get("maximum")) != NULL) {
+    if (v->type == Json::STR && v->str == "average") max_mode = ALUES_BOUND_AVERAGE;
+    else if (v->type == Json::NUM) {
+      max_mode = ALUES_BOUND_FIXED; maximum = v->num;
+    } else {
+      err = "maximum can only take 'average' or a number."; return false;
+    }
+  }
+  if ((v = req.get("sigma")) != NULL) {
+    opt.sigma = v->num;
+  }
+  if ((v = req.get("method")) != NULL) {
+    if (v->str == "minimum") method = ALUES_MINIMUM;
+    else if (v->str == "maximum") method = ALUES_MAXIMUM;
+    else if (v->str == "average") method = ALUES_AVERAGE;
+    else {
+      err = "method available are 'minimum', 'maximum' and 'average'."; return false;
+    }
+  }
+  return true;
+}
+
+// Cached model for the crop, settings and factors of a request, column is set
+// to the position of the model's factors among the request's
+static shared_ptr<const Model> get_model(const Json &req, const vector<string> &names, vector<int> &column,
+                                         string &err) {
+  const Json *crop = req.get("crop");
+  alues_options opt;
+  int method, min_mode, max_mode, k;
+  double minimum, maximum;
+  ostringstream key;
+
+  if (crop == NULL || crop->type != Json::STR || crop->str.empty() || crop->str.find('/') != string::npos ||
+      crop->str[0] == '.') {
+    err = "crop should name a requirement table in the crop directory."; return shared_ptr<const Model>();
+  }
+  if (!parse_options(req, opt, method, min_mode, minimum, max_mode, maximum, err)) {
+    return shared_ptr<const Model>();
+  }
+
+  shared_ptr<const Table> cr;
+  unsigned long gen;
+  {
+    lock_guard<mutex> guard(cache_lock);
+    map<string, shared_ptr<const Table> >::iterator table = crops.find(crop->str);
+    if (table != crops.end()) cr = table->second;
+    gen = generation;
+  }
+  // the table is read outside the lock, so that a slow disk does not hold up
+  // the requests for the crops already cached
+  if (!cr) {
+    shared_ptr<Table> t(new Table());
+    if (!read_csv((crop_dir + "/" + crop->str + ".csv").c_str(), *t)) {
+      err = "Cannot read crop requirements " + crop->str + "."; return shared_ptr<const Model>();
+    }
+    cr = t;
+  }
+  Requirements match;
+  match_requirements(*cr, names, match);
+  if (match.names.empty()) {
+    err = "No factor(s) to be evaluated, since none matches with the crop requirements."; return shared_ptr<const Model>();
+  }
+  column.swap(match.column);
+
+  key.precision(17);
+  key << crop->str << '|' << opt.mf << ',' << opt.bias << ',' << opt.sigma << ',' << method << ',' << min_mode << ','
+      << minimum << ',' << max_mode << ',' << maximum;
+  for (k = 0; k < 5; ++k) key << ',' << opt.l[k];
+  for (k = 0; k < (int) match.names.size(); ++k) key << '|' << match.names[k];
+  {
+    lock_guard<mutex> guard(cache_lock);
+    if (gen == generation) crops.insert(make_pair(crop->str, cr));
+    map<string, shared_ptr<const Model> >::iterator hit = models.find(key.str());
+    if (hit != models.end()) return hit->second;
+  }
+
+  shared_ptr<Model> model(new Model());
+  model->opt = opt; model->method = method; model->req = match;
+  init_requirements(*cr, min_mode, minimum, max_mode, maximum, model->req);
+
+  // whichever request inserts first wins, and nothing read before a reload is kept
+  lock_guard<mutex> guard(cache_lock);
+  if (gen != generation) return model;
+  return models.insert(make_pair(key.str(), shared_ptr<const Model>(model))).first->second;
+}
+
+// Scores a group of jobs sharing a model with one call per factor
+static void score_batch(const Model &model, const vector<Job *> &jobs) {
+  int i, k, m = (int) model.req.names.size(), n = 0, at;
+  for (size_t j = 0; j < jobs.size(); ++j) n += jobs[j]->n;
+
+  vector<double> x((size_t) n * m), score((size_t) n * m, NAN), overall(n), margin(n);
+  vector<int> cls((size_t) n * m, ALUES_NA), overall_cls(n), first(n), second(n);
+  for (k = 0; k < m; ++k) {
+    at = 0;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+      copy(jobs[j]->x.begin() + (size_t) k * jobs[j]->n, jobs[j]->x.begin() + (size_t) (k + 1) * jobs[j]->n,
+           x.begin() + (size_t) k * n + at);
+      at += jobs[j]->n;
+    }
+    alues_score(&model.req.factors[k], &model.opt, &x[(size_t) k * n], n, &score[(size_t) k * n], &cls[(size_t) k * n]);
+  }
+  alues_overall_limiting(score.data(), n, m, model.req.wts.data(), model.method, NULL, overall.data(), overall_cls.data(),
+                         first.data(), second.data(), margin.data());
+
+  at = 0;
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    Job &job = *jobs[j];
+    ostringstream out;
+    out << "{\"id\": " << job.id << ", \"factors\": [";
+    for (k = 0; k < m; ++k) out << (k > 0 ? ", " : "") << quote(model.req.names[k]);
+    out << "], \"score\": [";
+    for (i = 0; i < job.n; ++i) out << (i > 0 ? ", " : "") << format_number(overall[at + i]);
+    out << "], \"class\": [";
+    for (i = 0; i < job.n; ++i) out << (i > 0 ? ", " : "") << quote(alues_class_name(overall_cls[at + i]));
+    out << "], \"limiting\": [";
+    for (i = 0; i < job.n; ++i) {
+      out << (i > 0 ? ", " : "") << (first[at + i] < 0 ? "null" : quote(model.req.names[first[at + i]]));
+    }
+    out << "]}\n";
+    at += job.n;
+    job.sink->write_line(out.str());
+    stats.add(chrono::duration<double, micro>(Clock::now() - job.start).count());
+    job.sink->finish();
+    delete jobs[j];
+  }
+}
+
+// Takes whatever is queued, groups it by model and scores each group
+static void scorer() {
+  for (;;) {
+    vector<Job *> jobs;
+    {
+      unique_lock<mutex> guard(queue_lock);
+      queue_ready.wait(guard, [] { return !queue.empty() || stopping; });
+      if (queue.empty()) return;
+      if (window_us > 0) {
+        guard.unlock();
+        this_thread::sleep_for(chrono::microseconds(window_us));
+        guard.lock();
+      }
+      jobs.swap(queue);
+    }
+    map<const Model *, vector<Job *> > groups;
+    for (size_t j = 0; j < jobs.size(); ++j) {
+      groups[jobs[j]->model.get()].push_back(jobs[j]);
+    }
+    for (map<const Model *, vector<Job *> >::iterator g = groups.begin(); g != groups.end(); ++g) {
+      score_batch(*g->first, g->second);
+    }
+    lock_guard<mutex> guard(stats.lock);
+    stats.batches += groups.size();
+  }
+}
+
+static void handle_line(const string &line, const shared_ptr<Sink> &sink, Clock::time_point start) {
+  const char *p = line.c_str();
+  const Json *v, *id;
+  Json req;
+  string err, idjson = "null";
+
+  skip_space(p);
+  if (*p == '\0') return;
+  if (!parse_json(p, req) || req.type != Json::OBJ) {
+    sink->write_line("{\"id\": null, \"error\": \"Cannot parse request.\"}\n");
+    return;
+  }
+  if ((id = req.get("id")) != NULL) {
+    idjson = id->type == Json::STR ? quote(id->str) : id->type == Json::NUM ? format_number(id->num) : "null";
+  }
+  if ((v = req.get("op")) != NULL && v->str != "score") {
+    if (v->str == "stats") {
+      sink->write_line("{\"id\": " + idjson + ", \"stats\": " + stats.json() + "}\n");
+    } else if (v->str == "reload") {
+      lock_guard<mutex> guard(cache_lock);
+      crops.clear(); models.clear(); ++generation;
+      sink->write_line("{\"id\": " + idjson + ", \"reloaded\": true}\n");
+    } else {
+      sink->write_line("{\"id\": " + idjson + ", \"error\": \"op available are 'score', 'stats' and 'reload'.\"}\n");
+    }
+    return;
+  }
+
+  const Json *factors = req.get("factors"), *units = req.get("units");
+  vector<string> names;
+  if (factors == NULL || factors->type != Json::ARR || units == NULL || units->type != Json::ARR) {
+    sink->write_line("{\"id\": " + idjson + ", \"error\": \"factors and units should be arrays.\"}\n");
+    return;
+  }
+  for (size_t k = 0; k < factors->arr.size(); ++k) names.push_back(factors->arr[k].str);
+  Job *job = new Job();
+  shared_ptr<const Model> model = get_model(req, names, job->column, err);
+  if (!model) {
+    delete job;
+    sink->write_line("{\"id\": " + idjson + ", \"error\": " + quote(err) + "}\n");
+    return;
+  }
+
+  int n = (int) units->arr.size(), m = (int) model->req.names.size();
+  job->sink = sink; job->model = model; job->id = idjson; job->n = n; job->start = start;
+  job->x.resize((size_t) n * m);
+  for (int i = 0; i < n; ++i) {
+    const Json &row = units->arr[i];
+    if (row.type != Json::ARR || row.arr.size() != names.size()) {
+      delete job;
+      sink->write_line("{\"id\": " + idjson + ", \"error\": \"each unit should have one value per factor.\"}\n");
+      return;
+    }
+    for (int k = 0; k < m; ++k) {
+      const Json &cell = row.arr[job->column[k]];
+      job->x[(size_t) k * n + i] = cell.type == Json::NUM ? cell.num : NAN;
+    }
+  }
+  {
+    lock_guard<mutex> guard(queue_lock);
+    if (!stopping) {
+      {
+        lock_guard<mutex> inflight(sink->lock);
+        ++sink->inflight;
+      }
+      queue.push_back(job);
+      queue_ready.notify_one();
+      return;
+    }
+  }
+  delete job;
+  sink->write_line("{\"id\": " + idjson + ", \"error\": \"Server is shutting down.\"}\n");
+}
+
+// Reads requests line by line until the client hangs up or a shutdown is
+// requested, then waits for its replies to be written. A request longer than
+// max_line gets an error reply and the connection is closed, rather than
+// buffering it without bound.
+static void serve(int in, const shared_ptr<Sink> &sink) {
+  char buf[65536];
+  string pending;
+  size_t seen = 0;
+  ssize_t k;
+  struct pollfd fds[2] = {{in, POLLIN, 0}, {wake[0], POLLIN, 0}};
+  for (;;) {
+    if (poll(fds, 2, -1) < 0) {
+      if (errno == EINTR) continue;
+      break;
+    }
+    if (fds[1].revents != 0) {
+      // a partial line is dropped, the client did not finish it
+      pending.clear();
+      break;
+    }
+    k = read(in, buf, sizeof buf);
+    if (k == 0) break;
+    if (k < 0) {
+      if (errno == EINTR || errno == EAGAIN) continue;
+      break;
+    }
+    Clock::time_point start = Clock::now();
+    size_t from = 0, nl;
+    pending.append(buf, k);
+    // only the bytes just read can end the pending line
+    while ((nl = pending.find('\n', max(from, seen))) != string::npos && nl - from <= max_line) {
+      handle_line(pending.substr(from, nl - from), sink, start);
+      from = nl + 1;
+    }
+    pending.erase(0, from);
+    seen = pending.size();
+    if (pending.size() > max_line) {
+      sink->write_line("{\"id\": null, \"error\": \"Request is too long.\"}\n");
+      pending.clear();
+      break;
+    }
+  }
+  if (!pending.empty()) handle_line(pending, sink, Clock::now());
+  unique_lock<mutex> guard(sink->lock);
+  sink->idle.wait(guard, [&] { return sink->inflight == 0; });
+}
+
+static void serve_socket(int fd) {
+  serve(fd, make_shared<Sink>(fd));
+  close(fd);
+  lock_guard<mutex> guard(conn_lock);
+  if (--connections == 0) conn_done.notify_all();
+}
+
+int main(int argc, char **argv) {
+  const char *socket_path = NULL;
+  int i;
+
+  for (i = 1; i < argc; ++i) {
+    string arg = argv[i];
+    if (arg.compare(0, 2, "--") != 0) {
+      if (!crop_dir.empty()) {
+        usage(); return 1;
+      }
+      crop_dir = argv[i]; continue;
+    }
+    if (i + 1 >= argc) {
+      usage(); return 1;
+    }
+    const char *val = argv[++i];
+    if (arg == "--socket") {
+      socket_path = val;
+    } else if (arg == "--window") {
+      window_us = atol(val);
+    } else {
+      usage(); return 1;
+    }
+  }
+  if (crop_dir.empty() || window_us < 0) {
+    usage(); return 1;
+  }
+
+  // the socket is set up before any thread is started, so errors can return
+  int srv = -1;
+  if (socket_path != NULL) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof addr.sun_path) {
+      cerr << "socket path is too long.\n";
+      return 1;
+    }
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+    if ((srv = socket(AF_UNIX, SOCK_STREAM, 0)) < 0 || ::bind(srv, (struct sockaddr *) &addr, sizeof addr) < 0 ||
+        listen(srv, 128) < 0) {
+      cerr << "Cannot listen on " << socket_path << ": " << strerror(errno) << "\n";
+      return 1;
+    }
+  }
+  if (pipe(wake) < 0) {
+    cerr << "Cannot create pipe: " << strerror(errno) << "\n";
+    return 1;
+  }
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof sa);
+  sa.sa_handler = on_signal;
+  sigaction(SIGINT, &sa, NULL); sigaction(SIGTERM, &sa, NULL);
+  signal(SIGPIPE, SIG_IGN);
+  thread worker(scorer);
+
+  if (socket_path == NULL) {
+    serve(STDIN_FILENO, make_shared<Sink>(STDOUT_FILENO));
+  } else {
+    struct pollfd fds[2] = {{srv, POLLIN, 0}, {wake[0], POLLIN, 0}};
+    cerr << "alues-serve: listening on " << socket_path << "\n";
+    for (;;) {
+      if (poll(fds, 2, -1) < 0) {
+        if (errno == EINTR) continue;
+        cerr << "alues-serve: " << strerror(errno) << "\n";
+        break;
+      }
+      if (fds[1].revents != 0) break;
+      int fd = accept(srv, NULL, NULL);
+      if (fd < 0) {
+        if (errno == EINTR || errno == ECONNABORTED) continue;
+        // e.g. out of file descriptors, give up rather than spin
+        cerr << "alues-serve: " << strerror(errno) << "\n";
+        break;
+      }
+      {
+        lock_guard<mutex> guard(conn_lock);
+        ++connections;
+      }
+      thread(serve_socket, fd).detach();
+    }
+    close(srv);
+    unlink(socket_path);
+    // wakes the connections when the accept loop gave up on its own
+    on_signal(0);
+  }
+
+  // jobs queued so far are still scored, later ones get an error reply; the
+  // connections see the wake pipe too and are waited for before the scorer
+  // and the globals they use go away
+  {
+    lock_guard<mutex> guard(queue_lock);
+    stopping = true;
+    queue_ready.notify_one();
+  }
+  {
+    unique_lock<mutex> guard(conn_lock);
+    conn_done.wait(guard, [] { return connections == 0; });
+  }
+  worker.join();
+  cerr << "alues-serve: " << stats.json() << "\n";
+  return 0;
+}
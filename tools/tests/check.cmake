@@ -0,0 +1,39 @@
+# Runs PROGRAM with ARGS, feeding it INPUT on stdin if given, and checks that
+# it succeeds and prints EXPECTED. With SAME_AS, the output should instead
+# equal that of PROGRAM with these arguments. SORTED compares the lines
+# regardless of their order, for replies written by several threads.
+# Arguments are separated by | rather than ; which add_test would split.
+#
+#   cmake -DPROGRAM=... -DARGS=a|b [-DINPUT=...] [-DEXPECTED=...] [-DSAME_AS=c|d] [-DSORTED=ON] -P check.cmake
+
+function(sort_lines var)
+  if(SORTED)
+    string(REPLACE "\n" ";" text "${${var}}")
+    list(SORT text)
+    set(${var} "${text}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+function(run args out)
+  string(REPLACE "|" ";" args "${args}")
+  if(DEFINED INPUT)
+    set(stdin INPUT_FILE ${INPUT})
+  endif()
+  execute_process(COMMAND ${PROGRAM} ${args} ${stdin} RESULT_VARIABLE rc OUTPUT_VARIABLE text ERROR_VARIABLE err)
+  if(NOT rc EQUAL 0)
+    message(FATAL_ERROR "${PROGRAM} ${args} failed (${rc}):\n${err}")
+  endif()
+  sort_lines(text)
+  set(${out} "${text}" PARENT_SCOPE)
+endfunction()
+
+run("${ARGS}" actual)
+if(DEFINED SAME_AS)
+  run("${SAME_AS}" expected)
+else()
+  file(READ ${EXPECTED} expected)
+  sort_lines(expected)
+endif()
+if(NOT actual STREQUAL expected)
+  message(FATAL_ERROR "${PROGRAM} ${ARGS} printed\n${actual}\ninstead of\n${expected}")
+endif()